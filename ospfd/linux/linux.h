@@ -23,6 +23,7 @@
  */
 
 const int OSPFD_MON_PORT = 12767;
+const int OSPFD_STATS_PORT = 12768; // Prometheus exporter, localhost only
 
 class Linux : public OspfSysCalls {
     uns16 ospfd_mon_port;
@@ -30,6 +31,8 @@ class Linux : public OspfSysCalls {
     AVLtree monfds; // Current monitoring connections
   public:
     void monitor_response(struct MonMsg *, uns16, int, int);
+    uns32 usecs();
+    int monitor_backlog(int conn_id);
 
     Linux(uns16 mon_port);
     void mon_fd_set(int &, fd_set *, fd_set *);
@@ -0,0 +1,92 @@
+/*
+ *   OSPFD routing daemon
+ *   Copyright (C) 1998 by John T. Moy
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/* Batching writer of kernel routing table updates over
+ * rtnetlink. Requests are built in place in a single buffer
+ * (start() and then commit()) and sent with one system call,
+ * either when the buffer fills or when the main loop is
+ * about to block. Each request asks for an acknowledgment;
+ * requests are remembered by sequence number until it
+ * arrives, so that failures can be counted. Rather than
+ * keeping a copy of each request, a transient failure
+ * asks the owner to resend whatever it now wants installed
+ * for the request's key (prefix or next hop ID).
+ * When too many requests are outstanding, the writer
+ * reports itself busy and OSPF holds back further
+ * updates (see INrte::sys_install()).
+ */
+
+typedef void (*NlResend)(int type, uns32 key1, uns32 key2);
+
+class NlFib {
+    enum {
+        NLBUF_SIZE = 32768, // Size of batch buffer
+	MAX_PENDING = 2048, // Unacknowledged requests before busy
+	MAX_RETRIES = 3, // Per request
+	ACK_TIMEOUT = 5, // Seconds before giving up on ack
+    };
+    int fd;		// rtnetlink socket
+    uns32 *seqp;	// Shared netlink sequence number
+    char *buf;		// Batch being built
+    int buflen;		// Bytes used in batch
+    AVLtree pending;	// Requests awaiting ack, by sequence number
+    FibStats *stats;
+    NlResend resend;	// Rebuilds a failed request
+    int retries;	// Of requests being resent
+    void expire();
+    void discard();
+  public:
+    NlFib(int fd, uns32 *seqp, FibStats *stats, NlResend resend);
+    ~NlFib();
+    nlmsghdr *start(int size);
+    void commit(nlmsghdr *nlm, uns32 key1, uns32 key2);
+    void flush(bool block=false);
+    bool ack(nlmsgerr *errmsg);
+    bool acked(uns32 seq);
+    inline bool busy();
+    inline bool unsent();
+};
+
+inline bool NlFib::busy()
+
+{
+    return(pending.size() >= MAX_PENDING);
+}
+
+inline bool NlFib::unsent()
+
+{
+    return(buflen != 0);
+}
+
+/* A request that has been queued or sent, but not yet
+ * acknowledged. Indexed by netlink sequence number.
+ * Only the request's type and key are kept, for resending.
+ */
+
+class NlReq : public AVLitem {
+    int type;
+    uns32 key1;
+    uns32 key2;
+    int retries;
+    SPFtime tstamp;	// When queued
+  public:
+    NlReq(uns32 seq, int type, uns32 key1, uns32 key2, int retries);
+    friend class NlFib;
+};
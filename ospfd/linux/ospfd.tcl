@@ -419,7 +419,9 @@ proc tag {val} {
 ###############################################################
 # Interface authentication configuration:
 #	md5key _keyid_ _key_
-# subordinate to interface configuration
+#	hmackey _keyid_ _key_
+# subordinate to interface configuration. md5key configures
+# keyed MD5, hmackey HMAC-SHA-256 (RFC 5709).
 # subcommands:
 #	startaccept _date_
 #	startgenerate _date_
@@ -440,6 +442,13 @@ proc md5key {keyid key} {
     set md5_att($thisarea,$thisifc,$keyid,startgen) 0
     set md5_att($thisarea,$thisifc,$keyid,stopgen) 0
     set md5_att($thisarea,$thisifc,$keyid,stopacc) 0
+    set md5_att($thisarea,$thisifc,$keyid,alg) 0
+}
+
+proc hmackey {keyid key} {
+    global thisarea thisifc md5_att
+    md5key $keyid $key
+    set md5_att($thisarea,$thisifc,$keyid,alg) 1
 }
 
 ###############################################################
@@ -477,7 +486,8 @@ proc sendcfg {} {
 			$md5_att($a,$i,$key,startacc) \
 			$md5_att($a,$i,$key,startgen) \
 			$md5_att($a,$i,$key,stopgen) \
-			$md5_att($a,$i,$key,stopacc)
+			$md5_att($a,$i,$key,stopacc) \
+			$md5_att($a,$i,$key,alg)
 	    }
 	}
 	foreach aggr $area_att($a,aggregates) {
@@ -22,8 +22,23 @@
 class LinuxOspfd : public Linux {
     enum { 
         MAXIFs=255, // Maximum number of interfaces
+	RX_BATCH=64, // Low priority packets per pass of main loop
+	FIB_RETRY_MSEC=10, // Wait before resending route batch
+	LOG_POLL_MSEC=10, // Logging thread sleep when idle
+	RX_ERR_MSEC=1000, // Longest receive thread wait after errors
+	NH_DUMP_SIZE=32768, // Receive buffer for next hop dump
     };
     int netfd;	// File descriptor used to send and receive
+    pthread_t rx_thread; // Reads netfd on behalf of the main loop
+    int rx_wake[2]; // Pipe signalling packets queued by rx_thread
+    RxRing rx_hipri; // Hellos and Acks
+    RxRing rx_lopri; // All other OSPF packets
+    uns32 rx_drops; // Ring drops already logged
+    pthread_t stats_thread; // Serves counters to Prometheus
+    int statsfd; // Exporter listen socket
+    pthread_t log_thread; // Formats and writes logging messages
+    pthread_mutex_t log_lock; // Serializes writes to logstr
+    time_t log_base; // Wall clock time of sys_etime zero
     int igmpfd; // File descriptor for multicast routing
     int udpfd;	// UDP file descriptor for ioctl's
     int rtsock; // rtnetlink file descriptor
@@ -34,6 +49,17 @@ class LinuxOspfd : public Linux {
     AVLtree directs; // Directly attached prefixes
     rtentry m;
     uns32 nlm_seq;
+    NlFib *fib;	// Batches routing table updates
+    bool nh_objects; // Kernel supports next hop objects
+    uns32 next_nh_id; // Next ID for a single next hop
+    uns32 next_nhg_id; // Next ID for a next hop group
+    AVLtree krt_nhs; // Kernel next hop objects
+    AVLtree krt_nhgroups; // Kernel next hop groups, by ID
+    AVLtree krt_nhbinds; // Next hop group of each MPath
+    AVLtree krt_routes; // Next hop group of each installed prefix
+    AVLtree krt_moves; // Prefixes waiting to leave a shared group
+    AVLtree shadow; // Our routes, as we believe the kernel has them
+    bool shadow_complete; // Shadow includes kernel's initial dump
     FILE *logstr;
     bool changing_routerid;
     bool change_complete;
@@ -56,11 +82,14 @@ class LinuxOspfd : public Linux {
     void set_multicast_routing(int phyint, bool enabled);
     void rtadd(InAddr, InMask, MPath *, MPath *, bool); 
     void rtdel(InAddr, InMask, MPath *ompp);
-    void add_mcache(InAddr src, InAddr group, MCache *);
-    void del_mcache(InAddr src, InAddr group);
     void upload_remnants();
+    bool rt_busy();
+    uns32 rt_mark();
+    bool rt_done(uns32 mark);
     char *phyname(int phyint);
     void sys_spflog(int msgno, char *msgbuf);
+    void log_write(int msgno, time_t t, char *msgbuf);
+    void log_posted();
     void store_hitless_parms(int, int, struct MD5Seq *);
     void halt(int code, char *string);
 
@@ -68,16 +97,57 @@ class LinuxOspfd : public Linux {
     void read_kernel_interfaces();
     void one_second_timer();
     void rtentry_prepare(InAddr, InMask, MPath *mpp);
+    void rt_write(InAddr, InMask, MPath *, bool reject);
+    bool nh_pointopoint(int phyint);
+    static void nl_resend(int type, uns32 key1, uns32 key2);
+    void fib_resend(int type, uns32 key1, uns32 key2);
+    bool nh_probe();
+    void nh_dump();
+    void nh_dump_done();
+    class KrtNhGroup *nh_group(MPath *mpp);
+    bool nh_defer(InAddr net, InMask mask, MPath *mpp);
+    void nh_unmove(class KrtRoute *krt);
+    void nh_commit();
+    void nh_bind(class KrtNhGroup *grp, MPath *mpp);
+    void nh_unbind(class KrtNhGroup *grp);
+    void nh_rebind(class KrtNhGroup *grp, MPath *mpp);
+    class KrtNh *nh_single(InAddr gw, int phyint);
+    void nh_add(class KrtNh *);
+    void nhg_add(class KrtNhGroup *);
+    void nh_del(uns32 id);
+    void nh_track(InAddr net, InMask mask, class KrtNhGroup *grp);
+    void nh_free(class KrtNhGroup *grp);
+    void nh_phy_down(int phyint);
+    bool shadow_match(InAddr, InMask, MPath *, bool reject);
+    void shadow_set(InAddr, InMask, MPath *, bool reject);
+    void shadow_clear(InAddr, InMask);
+    void shadow_dump(InAddr, InMask, struct rtmsg *, int rta_len);
+    void rt_prefix(struct rtmsg *, int rta_len, InAddr &, InMask &);
     void add_direct(class BSDPhyInt *, InAddr, InMask);
     int get_phyint(InAddr);
     bool parse_interface(char *, in_addr &, BSDPhyInt * &);
     void raw_receive(int fd);
+    int raw_read(int fd, byte *buf, int len, int &rcvint);
+    void raw_dispatch(int rcvint, InPkt *pkt, int plen, uns32 rcvd=0);
+    void start_rx_thread();
+    void rx_loop();
+    bool rx_drain();
+    void rx_drain_hipri();
+    void start_stats_thread();
+    void stats_loop();
+    void stats_write(int fd);
+    void start_log_thread();
+    void log_loop();
+    void log_drain();
     void netlink_receive(int fd);
     void process_routerid_change();
     void set_flags(class BSDPhyInt *, short flags);
     friend int main(int argc, char *argv[]);
     friend int SendInterface(void *,struct Tcl_Interp *, int,char *[]);
     friend void quit(int);
+    friend void *rx_thread_main(void *);
+    friend void *stats_thread_main(void *);
+    friend void *log_thread_main(void *);
 };
 
 /* Representation of a physical interface.
@@ -175,5 +245,119 @@ class DirectRoute : public AVLitem {
     DirectRoute(InAddr addr, InMask mask) : AVLitem(addr, mask) {}
 };
 
+/* A next hop object installed in the kernel, shared by
+ * all of the next hop groups that use the same
+ * interface and gateway. Indexed by gateway and phyint.
+ */
+
+class KrtNh : public AVLitem {
+  public:
+    uns32 nh_id;
+    int n_users;	// Groups using this next hop
+    bool installed;	// False once kernel has flushed it
+    inline KrtNh(InAddr gw, int phyint, uns32 id);
+};
+
+inline KrtNh::KrtNh(InAddr gw, int phyint, uns32 id) : AVLitem(gw, phyint)
+
+{
+    nh_id = id;
+    n_users = 0;
+    installed = true;
+}
+
+/* A next hop group found in the kernel at startup, before
+ * its members have been resolved.
+ */
+
+class KrtNhDump : public AVLitem {
+  public:
+    int n_members;	// -1 if too many
+    uns32 ids[MAXPATH];
+    KrtNhDump(uns32 id) : AVLitem(id, 0), n_members(0) {}
+};
+
+/* A kernel next hop group. Its ID stays the same for as
+ * long as any prefix uses it: when all of the prefixes
+ * using a group move to the same new set of next hops,
+ * the group is rewritten in place and the prefixes
+ * themselves are left alone. Indexed by ID; the
+ * KrtNhBind entries map OSPF's MPaths to their group.
+ */
+
+class KrtNhGroup : public AVLitem {
+  public:
+    uns32 nh_id;
+    MPath *mpp;		// Next hops now installed
+    int n_users;	// Routes using this group
+    bool installed;	// False once kernel has flushed a member
+    int npaths;
+    KrtNh *members[MAXPATH];
+    int n_moving;	// Users waiting in krt_moves
+    MPath *target;	// Where the first of them is going
+    bool split;		// Users going to different places
+    inline KrtNhGroup(uns32 id);
+};
+
+inline KrtNhGroup::KrtNhGroup(uns32 id) : AVLitem(id, 0)
+
+{
+    nh_id = id;
+    mpp = 0;
+    n_users = 0;
+    installed = true;
+    npaths = 0;
+    n_moving = 0;
+    target = 0;
+    split = false;
+}
+
+/* The group currently installing a given MPath. Indexed
+ * by the address of the MPath, which OSPF never changes
+ * once created.
+ */
+
+class KrtNhBind : public AVLitem {
+  public:
+    KrtNhGroup *grp;
+    inline KrtNhBind(MPath *mpp, KrtNhGroup *grp);
+};
+
+inline KrtNhBind::KrtNhBind(MPath *mpp, KrtNhGroup *_grp)
+    : AVLitem((uns32) (uintptr_t) mpp,
+	      (uns32) (((uint64_t) (uintptr_t) mpp) >> 32))
+
+{
+    grp = _grp;
+}
+
+/* The next hop group through which a prefix has been
+ * installed in the kernel, and the next hops it is to move
+ * to once nh_commit() runs.
+ */
+
+class KrtRoute : public AVLitem {
+  public:
+    KrtNhGroup *grp;
+    MPath *move;
+    KrtRoute(InAddr net, InMask mask) : AVLitem(net, mask), grp(0), move(0) {}
+};
+
+/* Shadow copy of one of our kernel routing table
+ * entries. Next hops are stored as they were given to
+ * the kernel: point-to-point hops by interface alone.
+ * npaths is -1 when the kernel reported the entry in a
+ * form we can't compare against (e.g., by next hop ID).
+ */
+
+class KrtShadow : public AVLitem {
+  public:
+    bool reject;
+    int npaths;
+    InAddr gw[MAXPATH];
+    int phyint[MAXPATH];
+    KrtShadow(InAddr net, InMask mask) : AVLitem(net, mask) {}
+};
+
 // Maximum size of an IP packet
 const int MAX_IP_PKTSIZE = 65535;
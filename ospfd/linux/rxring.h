@@ -0,0 +1,130 @@
+/*
+ *   OSPFD routing daemon
+ *   Copyright (C) 1998 by John T. Moy
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/* Single-producer, single-consumer ring of received
+ * packets. The receive thread is the only writer of
+ * "tail", and the protocol thread the only writer of
+ * "head", so no locks are needed: each side publishes
+ * its index with release semantics after touching the slot,
+ * and reads the other side's index with acquire semantics.
+ * Each slot has its own buffer, allocated with the ring,
+ * so that queuing a packet costs a copy but no allocation.
+ * Packets too large for the slot buffer (jumbo frames)
+ * are allocated separately, and freed on release.
+ */
+
+class RxRing {
+    enum {
+        RXRING_SIZE = 512, // Number of slots, power of two
+	RXSLOT_SIZE = 2048, // Preallocated bytes per slot
+    };
+    struct RxSlot {
+        int phyint;	// Receiving interface
+	int len;	// Length of packet
+	uns32 rcvd;	// When read, in usecs
+	byte *data;	// Packet, including IP header
+	byte buf[RXSLOT_SIZE];
+    };
+    RxSlot slots[RXRING_SIZE];
+    uns32 head;		// Next slot to read
+    uns32 tail;		// Next slot to write
+    uns32 drops;	// Packets discarded, ring full
+  public:
+    inline RxRing();
+    inline bool put(int phyint, byte *pkt, int len, uns32 rcvd);
+    inline bool get(int &phyint, byte * &data, int &len, uns32 &rcvd);
+    inline void release();
+    inline bool empty();
+    inline uns32 n_drops();
+};
+
+inline RxRing::RxRing() : head(0), tail(0), drops(0)
+
+{
+}
+
+/* Called by the receive thread only. Copies the packet
+ * into the next slot. Returns false if the ring is full.
+ */
+
+inline bool RxRing::put(int phyint, byte *pkt, int len, uns32 rcvd)
+
+{
+    RxSlot *slot;
+    uns32 t = tail;
+    if (t - __atomic_load_n(&head, __ATOMIC_ACQUIRE) == RXRING_SIZE) {
+        __atomic_store_n(&drops, drops+1, __ATOMIC_RELAXED);
+	return(false);
+    }
+    slot = &slots[t & (RXRING_SIZE-1)];
+    slot->phyint = phyint;
+    slot->len = len;
+    slot->rcvd = rcvd;
+    slot->data = (len <= RXSLOT_SIZE) ? slot->buf : new byte[len];
+    memcpy(slot->data, pkt, len);
+    __atomic_store_n(&tail, t+1, __ATOMIC_RELEASE);
+    return(true);
+}
+
+/* Called by the protocol thread only. Returns the oldest
+ * packet, which stays in the ring, and valid, until
+ * release() is called.
+ */
+
+inline bool RxRing::get(int &phyint, byte * &data, int &len, uns32 &rcvd)
+
+{
+    RxSlot *slot;
+    uns32 h = head;
+    if (h == __atomic_load_n(&tail, __ATOMIC_ACQUIRE))
+        return(false);
+    slot = &slots[h & (RXRING_SIZE-1)];
+    phyint = slot->phyint;
+    len = slot->len;
+    rcvd = slot->rcvd;
+    data = slot->data;
+    return(true);
+}
+
+/* Give the slot returned by get() back to the receive
+ * thread.
+ */
+
+inline void RxRing::release()
+
+{
+    RxSlot *slot;
+    uns32 h = head;
+    slot = &slots[h & (RXRING_SIZE-1)];
+    if (slot->data != slot->buf)
+        delete [] slot->data;
+    __atomic_store_n(&head, h+1, __ATOMIC_RELEASE);
+}
+
+inline bool RxRing::empty()
+
+{
+    return(head == __atomic_load_n(&tail, __ATOMIC_ACQUIRE));
+}
+
+inline uns32 RxRing::n_drops()
+
+{
+    return(__atomic_load_n(&drops, __ATOMIC_RELAXED));
+}
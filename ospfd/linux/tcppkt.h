@@ -33,38 +33,53 @@ struct TcpPktHdr {
     uns16 length;
 };
 
-/* Class for queueing packet tranmissions.
+/* Queued packet transmission. The body is owned by
+ * the queue, and freed once the packet has been sent.
  */
 
-class PktList {
-    PktList *next;
+struct XmtSlot {
     TcpPktHdr hdr;
     byte *body;
-  public:
-    friend class TcpPkt;
 };
 
 /* Class for receiving and transmitting packets
- * over the TCP stream.
+ * over the TCP stream. Transmissions are queued in
+ * a ring, which grows as needed, and as many queued
+ * packets as possible are written with a single writev().
  */
 
 class TcpPkt {
+    enum {
+        XMT_RING_INIT = 64, // Initial ring size, power of two
+	XMT_BATCH = 64,	// Packets per writev()
+	RCV_BATCH = 16384, // Read-ahead buffer, nonblocking mode
+    };
     int fd;		// File descriptor
     // Receive parameters
     byte *rcvbuff;	// Receive staging area
     int blen;		// Length of staging area
     int offset;		// Current offset into staging area
+    bool batched;	// Nonblocking, reading ahead
+    int rcv_start;	// Start of unreturned data, if batched
     // Transmit parameters
-    int xmt_done;	// Amount of current transmission completed
-    PktList *xmt_head;  // Queued transmissions
-    PktList *xmt_tail;
+    int xmt_done;	// Amount of head packet already sent
+    XmtSlot *xmt_ring;	// Queued transmissions
+    uns32 xmt_size;	// Slots in ring
+    uns32 xmt_head;	// Next packet to send
+    uns32 xmt_tail;	// Next free slot
+    XmtSlot *xmt_slot(uns16 type, uns16 subtype, int len);
+    int receive_batched(void **fullmsg, uns16 &, uns16 &);
   public:
     TcpPkt(int fd);
     ~TcpPkt();
+    void set_nonblocking();
+    void adopt_rcv(TcpPkt *);
     int receive(void **fullmsg, uns16 &, uns16 &);
     int rcv_suspend(void **mp, uns16 &type, uns16 &subtype);
     void queue_xpkt(void *, uns16 type, uns16 subtype, int len);
+    void queue_xpkt_owned(byte *, uns16 type, uns16 subtype, int len);
     bool sendpkt();
     bool sendpkt_suspend(void *, uns16, uns16, int);
     bool xmt_pending();
+    int xmt_count();
 };
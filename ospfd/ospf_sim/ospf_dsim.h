@@ -0,0 +1,257 @@
+
+/* Single-process discrete event simulator. Every simulated
+ * router is an OSPF instance inside this one process, with
+ * its own OspfContext, and is its own system interface.
+ * Packets between routers and the routers' timer wakeups
+ * are events on a single queue ordered by simulated time.
+ * The simulation jumps from one event to the next, so there
+ * are no ticks, and no sockets or processes per router.
+ */
+
+class DSimNode;
+class DSimSeg;
+
+/* Kinds of event.
+ */
+
+enum {
+    DSIM_PKT = 1,	// Packet delivery
+    DSIM_WAKEUP,	// Router's next timer is due
+};
+
+/* An event on the simulation queue. Time is in
+ * milliseconds since the simulation started; events
+ * at the same time are taken in the order scheduled.
+ * A packet delivery owns its copy of the packet.
+ */
+
+class DSimEvent : public PriQElt {
+    int type;
+    DSimNode *node;	// Receiving or waking router
+    int phyint;		// Receiving interface
+    InPkt *pkt;		// Packet being delivered
+  public:
+    DSimEvent(int type, DSimNode *);
+    inline uns32 when();
+    friend class DSim;
+    friend class DSimNode;
+};
+
+inline uns32 DSimEvent::when()
+{
+    return(cost0);
+}
+
+/* A network segment: a broadcast, NBMA or Point-to-
+ * MultiPoint network, or a point-to-point link. Its
+ * number is the phyint used by every attached router.
+ */
+
+class DSimSeg : public AVLitem {
+    int type;		// IFT_BROADCAST, etc.
+    InAddr net;
+    InMask mask;
+    aid_t area;
+    int demand;
+    class DSimPort *ports; // Attached router interfaces
+    // Link parameters, from the "impair" command
+    uns32 delay;	// Milliseconds
+    uns32 jitter;	// Up to this many milliseconds more
+    uns32 loss;		// Parts per million, for each receiver
+    uns32 bandwidth;	// Kilobits/second, 0 if unlimited
+    uns32 mtu;		// Bytes, 0 if unlimited
+  public:
+    DSimSeg(int port, int type);
+    friend class DSim;
+    friend class DSimNode;
+    friend class DSimPort;
+};
+
+/* A router's attachment to a segment, and the
+ * configuration of the OSPF interface there.
+ */
+
+class DSimPort : public AVLitem {
+    DSimNode *node;
+    DSimSeg *seg;
+    DSimPort *next;	// Next on segment
+    InAddr addr;
+    InMask mask;
+    aid_t area;
+    int ifindex;
+    uns16 cost;
+    byte drpri;
+    int passive;
+    int run_ospf;
+    uns32 busy;		// Transmitter free at this time
+    uns32 busy_usec;	// plus this many microseconds
+  public:
+    DSimPort(DSimNode *, DSimSeg *, InAddr addr, int ifindex);
+    friend class DSim;
+    friend class DSimNode;
+};
+
+/* Map from an interface or loopback address to the
+ * router that owns it.
+ */
+
+class DSimAddr : public AVLitem {
+    DSimNode *node;
+  public:
+    DSimAddr(InAddr addr, DSimNode *);
+    friend class DSim;
+    friend class DSimNode;
+};
+
+/* Stub area parameters, from the "stub" command.
+ */
+
+class DSimArea : public AVLitem {
+    int stub;
+    uns32 dflt_cost;
+    int import_summs;
+  public:
+    DSimArea(aid_t id);
+    friend class DSim;
+    friend class DSimNode;
+};
+
+/* Configuration items that are kept as they will
+ * be downloaded: hosts, ranges and neighbors.
+ */
+
+struct DSimCfg {
+    DSimCfg *next;
+    int type;		// CfgType_Host, etc.
+    int len;
+    union {
+	CfgHost host;
+	CfgRnge range;
+	CfgNbr nbr;
+    };
+};
+
+/* A simulated router. Implements the system interface
+ * for its OSPF instance.
+ */
+
+class DSimNode : public AVLitem, public OspfSysCalls {
+    OspfContext ctx;
+    AVLtree ports;	// Segment attachments, by phyint
+    AVLtree membership; // Joined groups, by (group, phyint)
+    DSimCfg *cfg_head;	// Extra configuration, in order
+    DSimCfg *cfg_tail;
+    DSimEvent wakeup;	// Timer event
+    bool wakeup_queued;
+    bool halted;	// OSPF asked to exit
+    bool forwarding;
+    int host_mode;
+    int mospf;
+    int PPAdjLimit;
+    char namebuf[16];
+  public:
+    DSimNode(rtid_t id);
+    ~DSimNode();
+    inline rtid_t id();
+    void add_cfg(int type, void *msg, int len);
+    void start();
+    void configure();
+    void add_area(aid_t id, AVLtree *done);
+    void receive(int phyint, InPkt *pkt);
+    void forward(InPkt *pkt, int phyint);
+    void reschedule();
+    void db_stats(class DSimTally *);
+
+    void sendpkt(InPkt *pkt, int phyint, InAddr gw=0);
+    void sendpkt(InPkt *pkt);
+    bool phy_operational(int phyint);
+    void phy_open(int phyint);
+    void phy_close(int phyint);
+    void join(InAddr group, int phyint);
+    void leave(InAddr group, int phyint);
+    void ip_forward(bool enabled);
+    void set_multicast_routing(bool enabled);
+    void set_multicast_routing(int phyint, bool enabled);
+    void rtadd(InAddr, InMask, MPath *, MPath *, bool);
+    void rtdel(InAddr, InMask, MPath *);
+    void upload_remnants();
+    void monitor_response(struct MonMsg *, uns16, int, int);
+    char *phyname(int phyint);
+    void sys_spflog(int msgno, char *msgbuf);
+    void store_hitless_parms(int, int, struct MD5Seq *);
+    void halt(int code, char *string);
+
+    friend class DSim;
+    friend class DSimPort;
+};
+
+inline rtid_t DSimNode::id()
+{
+    return(index1());
+}
+
+/* Per-area count of routers holding each distinct
+ * link-state database, used to judge synchronization.
+ */
+
+class DSimTally {
+  public:
+    AVLtree areas;	// Routers per area
+    AVLtree dbs;	// Routers per (area, database checksum)
+    AVLtree ext_dbs;	// Routers per AS-external checksum
+    void count(AVLtree *, uns32 a, uns32 b);
+};
+
+class DSimCount : public AVLitem {
+  public:
+    int n;
+    inline DSimCount(uns32 a, uns32 b);
+};
+
+inline DSimCount::DSimCount(uns32 a, uns32 b) : AVLitem(a, b)
+{
+    n = 0;
+}
+
+/* The simulation itself.
+ */
+
+class DSim {
+    PriQ events;
+    uns32 now;		// Milliseconds since start
+    uns32 seqno;	// Orders simultaneous events
+    AVLtree nodes;	// Routers, by Router ID
+    AVLtree segs;	// Segments, by number
+    AVLtree addrs;	// Interface address to owning router
+    AVLtree areas;	// Stub area parameters
+    class SimConfig *cfg; // Topology, as read
+    int log_priority;
+    bool random_refresh;
+    // Statistics
+    uns32 n_events;
+    uns32 n_pkts;	// Packets delivered
+    uns32 n_drops;	// Packets that could not be delivered
+    uns32 n_lost;	// Packets lost to link parameters
+    uns32 n_logs;	// Logging messages
+  public:
+    DSim(int log_priority);
+    bool read_config(char *filename);
+    void add_seg(int phyint);
+    void schedule(DSimEvent *, uns32 delay);
+    uns32 transit(DSimPort *, int len);
+    void deliver(DSimPort *, InPkt *pkt, uns32 delay);
+    void start();
+    void run(uns32 duration);
+    void report(FILE *, double wall_secs);
+    inline uns32 elapsed();
+
+    friend class DSimNode;
+    friend class DSimPort;
+};
+
+inline uns32 DSim::elapsed()
+{
+    return(now);
+}
+
+extern DSim *dsim;
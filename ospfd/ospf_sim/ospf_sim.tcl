@@ -41,12 +41,14 @@ global {vlinks}
 global {sessions}
 global {session_ids}
 global {random_refresh_flag}
+global {impairs}
 
 set routers {}
 set areas {}
 set networks {}
 set vlinks {}
 set sessions {}
+set impairs {}
 set interface_index 0
 set pplink_index 0
 set vlink_index 0
@@ -83,6 +85,7 @@ set TTL_EXPIRED 11
 #	neighbor %rtr_id %addr %drpri
 #	membership %prefix %group
 #	PPAdjLimit %rtr_id %nadj
+#	impair %rtr_id %peer %delay %jitter %loss %bandwidth %mtu
 #
 # Almost all of these operations can also be accomplished
 # through the GUI.
@@ -423,6 +426,18 @@ proc PPAdjLimit {rtr_id nadj} {
     set router_att($rtr_id,PPAdjLimit) $nadj
 }
 
+###############################################################
+# Set the delay, jitter, loss, bandwidth and MTU of the
+# link from a router to a neighbor (or network prefix).
+# The controller applies these when it reads the file,
+# so they are only remembered here, to be saved again.
+###############################################################
+
+proc impair {rtr_id peer delay jitter loss bandwidth mtu} {
+    global impairs
+    lappend impairs [list $rtr_id $peer $delay $jitter $loss $bandwidth $mtu]
+}
+
 ###############################################################
 # Set *all* simulated routers to randomly refresh.
 # By default, this function is disabled.
@@ -1433,7 +1448,7 @@ proc SaveMap {} {
     global router_att area_att ifc_att vlink_att vlinks
     global aggr_att route_att host_att nbr_att node_att
     global network_att aggr_att route_att nbr_att
-    global host_att random_refresh_flag
+    global host_att random_refresh_flag impairs
 
     set f [open $config_file w]
     if {$random_refresh_flag != 0} {
@@ -1511,6 +1526,9 @@ proc SaveMap {} {
 	puts $f [concat vlink $vlink_att($vl,end0) $vlink_att($vl,endpt) \
 		$vlink_att($vl,area)]
     }
+    foreach imp $impairs {
+	puts $f [concat impair $imp]
+    }
     close $f
 }
 
@@ -65,9 +65,15 @@ class SimSys : public Linux {
     AVLtree port_map; // Phyint to file descriptor mapping
     AVLtree membership; // Interface group membership		   
     SimRttbl rttbl;	// Routing table
-    SimPktQ *rcv_head;  // Queued receives
-    SimPktQ *rcv_tail;
+    PriQ rcv_queue;	// Queued receives, by delivery time
+    SimPktQ *rcv_free;	// Pool of receive buffers
+    uns32 rcv_seq;	// Keeps equal times in arrival order
+    AVLtree xmt_rings;	// Shared memory rings we write, by phyint
+    AVLtree rcv_rings;	// Neighbors' rings we read
+    bool rings_changed;	// Rings to attach or detach
     SPFtime xmt_stamp; // Transmission timestamp
+    bool xmt_active;	// Sent packets since last tick response
+    uns32 n_lost;	// Packets lost to link parameters
     bool ipforwarding; // Whether IP forwarding is enabled
     AVLtree pings;	// Active ping sessions
     AVLtree traceroutes;// Active traceroute sessions
@@ -77,6 +83,7 @@ class SimSys : public Linux {
     bool hitless_preparation;
     bool hitless_preparation_complete;
     SPFtime grace_period;
+    bool hitless_exit;	// Old instance going away, keep routes
   public:
     SimSys(int fd);
     ~SimSys();
@@ -100,6 +107,12 @@ class SimSys : public Linux {
     void halt(int code, char *string);
 
     void process_uni_fd();
+    void deliver(struct SimPktHdr *pkthdr, int plen);
+    void attach_rings();
+    void drain_rings();
+    bool ring_send(struct SimPktHdr *, size_t, int phyint, InAddr, uns16);
+    void send_doorbell(uns16 port);
+    void remove_rings();
     void rxpkt(struct SimPktHdr *pkthdr);
     void local_demux(SimPktHdr *pkthdr);
     void igmp_demux(int phyint, InPkt *pkt);
@@ -116,6 +129,10 @@ class SimSys : public Linux {
     void config(int type, int subtype, void *msg);
     void send_tick_response();
     InAddr ip_source(InAddr dest);
+    bool phy_failed(int phyint);
+    void set_link_parms(struct LinkParms *);
+    bool link_transit(struct SimPktHdr *, size_t len);
+    bool link_lost(int phyint);
 
     friend int main(int argc, char *argv[]);
     friend class PingSession;
@@ -145,6 +162,14 @@ class PhyintMap : public AVLitem {
     char name[8];
     InAddr addr;
     InMask mask;
+    // Segment parameters, see LinkParms
+    int delay;
+    int jitter;
+    uns32 loss;
+    int bandwidth;
+    int mtu;
+    SPFtime busy;	// Transmitter free at this time
+    int busy_usec;	// plus this many microseconds
   public:
     PhyintMap(int phyint);
     friend class SimSys;
@@ -161,13 +186,23 @@ struct SimPktHdr {
     int phyint;		// Associate physical interface
 };
 
-class SimPktQ {
-    SimPktQ *next;
+/* A received packet waiting for its delivery time,
+ * which is the element's cost. When delivered, the
+ * element and its buffer go back on a free list to
+ * be reused for later packets.
+ */
+
+class SimPktQ : public PriQElt {
+    SimPktQ *next;	// In free list
     SimPktHdr *ip_data;
+    int size;		// Buffer size
   public:
     friend class SimSys;
 };
 
+// Initial size of queued packet buffers
+const int SIM_PKTBUF = 2048;
+
 /* Class implementing a ping session. Pings sent
  * on a timer.
  */
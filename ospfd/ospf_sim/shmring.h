@@ -0,0 +1,96 @@
+
+/* Shared memory packet rings between the simulated
+ * routers on a host. Each router creates a ring for
+ * every segment it attaches to, and is that ring's only
+ * writer. The other routers on the segment attach as
+ * readers, each claiming a slot in the ring header where
+ * it keeps its own read position. A packet multicast
+ * onto the segment is then written once and read by all
+ * the neighbors; a unicast is tagged with the Router ID
+ * of its one reader, and skipped by the rest.
+ * A reader is woken by a zero-length datagram on its
+ * unicast socket (the doorbell), sent only if its
+ * doorbell flag was clear, so that a burst of packets
+ * costs a single wakeup. Neighbors that have not
+ * attached, and packets that do not fit in the ring,
+ * go over the socket as before.
+ * A reader claims a slot by marking it with its Router ID
+ * and SHM_CLAIMING. The writer then sets the slot's
+ * positions to its own, before writing its next packet,
+ * and clears the mark. A packet is therefore either
+ * sent over the socket or read from the ring, never both.
+ */
+
+const int SHM_RING_SIZE = 64*1024;	// Packet data, power of two
+const int SHM_RING_READERS = 32;	// Slots per ring
+const uns32 SHM_RING_MAGIC = 0x4f535246;
+
+/* A slot's owner holds the reader's Router ID, and the
+ * claiming mark in the same word, so that the writer's
+ * change from one to the other can't take over a slot
+ * since given to another reader.
+ */
+
+typedef unsigned long long ShmOwner;
+const ShmOwner SHM_CLAIMING = 1ULL << 32;	// Positions not yet set
+
+/* A reader's slot in the ring header.
+ */
+
+struct ShmReader {
+    ShmOwner owner;	// Reader's Router ID, 0 if free
+    uns32 start;	// Position when attached
+    uns32 tail;		// Next byte to read
+    uns32 rung;		// Doorbell sent, reader not yet run
+    uns32 pad;
+};
+
+struct ShmRingHdr {
+    uns32 magic;	// Set once initialized
+    uns32 size;		// Bytes of packet data
+    uns32 head;		// Next byte to write
+    uns32 pad;
+    ShmReader readers[SHM_RING_READERS];
+};
+
+/* Header of each record in the ring. Records are padded
+ * to 8 bytes, and never split across the end of the ring:
+ * a length of SHM_REC_WRAP says that the record is instead
+ * at the beginning.
+ */
+
+struct ShmRecHdr {
+    uns32 len;		// SimPktHdr and packet
+    uns32 dest;		// Reader's Router ID, 0 for all
+};
+
+const uns32 SHM_REC_WRAP = 0xffffffff;
+
+/* One ring, as seen by its writer (indexed by phyint)
+ * or by one of its readers (indexed by phyint and the
+ * writer's Router ID).
+ */
+
+class ShmRing : public AVLitem {
+    char name[32];	// Shared memory object
+    uns16 port;		// Writer's unicast port
+    ShmRingHdr *hdr;	// 0 if not mapped
+    byte *data;
+    int slot;		// Reader's slot, -1 for the writer
+    InAddr self;	// Reader's Router ID
+    bool map(bool create);
+    void unmap();
+    bool admit(ShmReader *, uns32 h);
+  public:
+    ShmRing(int phyint, InAddr home, uns16 port);
+    ~ShmRing();
+    bool create();
+    bool attach(InAddr id);
+    bool write(SimPktHdr *pkt, int len, InAddr dest, uns32 &pos);
+    int reader(InAddr id, uns32 pos);
+    bool doorbell(int rslot);
+    void release(InAddr id);
+    int read(byte *buf);
+    void unlink();
+    friend class SimSys;
+};
@@ -1,6 +1,7 @@
 
 const int TICKS_PER_SECOND = 20; // Simulated time granularity
-const int LINK_DELAY = 10;	// Simulated link delay (milliseconds)
+const int LINK_DELAY = 10;	// Default link delay (milliseconds)
+const int MAX_SIM_MSG = 65000;	// Longest message body, as length is 16 bits
 
 /* Packet types exchanged between the simulation
  * controller and the individual ospfd simulations.
@@ -23,6 +24,11 @@ enum {
     SIM_START_MTRACE,	// Start multicast traceroute session
     SIM_RESTART,	// Restart router
     SIM_RESTART_HITLESS,// Hitless restart of router
+    SIM_LINK_DOWN,	// Segment has failed, phyint in subtype
+    SIM_LINK_UP,	// Segment has been repaired
+    SIM_CRASH,		// Exit without shutting down OSPF
+    SIM_CONFIG_BATCH,	// Several config messages, see CfgBatchHdr
+    SIM_LINK_PARMS,	// Segment's delay, loss, etc., see LinkParms
 
     // Responses from ospfds
     SIM_HELLO = 100,	// Initial identification
@@ -85,6 +91,38 @@ struct HitlessRestartMsg {
     uns16 period;
 };
 
+/* Each entry in a SIM_CONFIG_BATCH message starts with
+ * this header, giving the type (SIM_CONFIG,
+ * SIM_CONFIG_DEL or SIM_LINK_PARMS), subtype and length
+ * that the entry would have had as a message of its own.
+ * The body follows, padded to a multiple of four bytes.
+ */
+
+struct CfgBatchHdr {
+    uns16 type;
+    uns16 subtype;
+    uns16 length;
+    uns16 pad;
+};
+
+/* Body of the Link parameters message, describing the
+ * segment a router's interface attaches to. The sending
+ * router applies them to each packet: the packet waits
+ * for earlier ones to be transmitted at the segment's
+ * bandwidth, and then arrives after the delay plus a
+ * random jitter, unless it is lost or is larger than
+ * the MTU.
+ */
+
+struct LinkParms {
+    int32 phyint;
+    uns32 delay;	// Milliseconds
+    uns32 jitter;	// Up to this many milliseconds more
+    uns32 loss;		// Parts per million, for each receiver
+    uns32 bandwidth;	// Kilobits/second, 0 if unlimited
+    uns32 mtu;		// Bytes, 0 if unlimited
+};
+
 /* Tick responses carry the #LSAs and checksum for 
  * AS-externals and each area, so that the controller
  * can tell whether the routers' databases are
@@ -99,6 +137,31 @@ struct DBStats {
     uns32 dbxsum;	// Area database checksum
 };
 
+/* Body of the tick response. next_tick is the number
+ * of ticks the router can go without one: 1 if it
+ * needs the next tick, 0 if it has no timers pending.
+ * The remaining fields tell whether the router is
+ * still working towards convergence. The response is
+ * followed by n_adjs SimAdj entries, one for each
+ * neighbor that the router is fully adjacent to.
+ */
+
+struct TickResponse {
+    DBStats dbstats;
+    uns32 next_tick;
+    uns32 n_rxmts;	// LSAs awaiting acknowledgment
+    uns32 n_exchanges;	// Neighbors in database exchange
+    uns32 calc_pending;	// Routing calculation scheduled
+    uns32 n_lost;	// Packets lost to link parameters, ever
+    uns32 running;	// OSPF is running
+    uns32 n_adjs;	// Full adjacencies that follow
+};
+
+struct SimAdj {
+    int phyint;
+    rtid_t nbr_id;
+};
+
 /* Body of the Echo reply response.
  * The ID of the session is carried in the
  * message subtype.
@@ -0,0 +1,227 @@
+
+/* The simulated topology, as read from the configuration
+ * file. The file is parsed in one pass into flat arrays,
+ * growing as needed, with AVL indexes for the lookups
+ * that parsing needs. Each router's areas, interfaces and
+ * hosts are then chained together in file order, as are
+ * the interfaces attached to each segment, so that a
+ * router's configuration can be downloaded in one pass,
+ * batched into as few messages as possible. Both
+ * ospf_simbatch and ospf_dsim read their topology this way.
+ * Understood:
+ *	router id x y mospf
+ *	host id x y
+ *	broadcast prefix area x y demand
+ *	nbma prefix area x y demand
+ *	ptmp prefix area x y demand
+ *	interface router address cost passive run_ospf
+ *	pplink router1 addr1 cost1 router2 addr2 cost2 area demand
+ *	drpri router address priority
+ *	aggr router area prefix noadv
+ *	stub area default_cost import
+ *	loopback router prefix area
+ *	neighbor router address dr_eligible
+ *	PPAdjLimit router n_adjacencies
+ *	random_refresh
+ *	impair router peer delay jitter loss bandwidth mtu
+ * Other commands, which the Tk front end understands,
+ * are skipped.
+ */
+
+struct SimRtrCfg {
+    rtid_t id;
+    int host_mode;
+    int mospf;
+    int PPAdjLimit;
+    int areas;		// First area, -1 if none
+    int ifcs;		// First interface
+    int hosts;		// First loopback
+    int ranges;		// First area address range
+    int nbrs;		// First configured neighbor
+};
+
+struct SimNetCfg {
+    int type;		// IFT_BROADCAST, IFT_NBMA or IFT_P2MP
+    InAddr net;
+    InMask mask;
+    aid_t area;
+    int demand;
+    int phyint;
+};
+
+struct SimIfcCfg {
+    int rtr;		// Owning router
+    int next;		// Next of the router's interfaces
+    int seg_next;	// Next on the same segment
+    int type;		// IFT_PP, or that of the network
+    int phyint;
+    int ifindex;
+    InAddr addr;
+    InMask mask;
+    aid_t area;
+    int cost;
+    int demand;
+    int passive;
+    int run_ospf;
+    byte dr_pri;
+};
+
+struct SimAreaCfg {
+    aid_t id;
+    int next;		// Router's next area
+};
+
+struct SimHostCfg {
+    int rtr;
+    int next;		// Router's next loopback
+    InAddr net;
+    InMask mask;
+    aid_t area;
+};
+
+struct SimRangeCfg {
+    int rtr;
+    int next;		// Router's next range
+    InAddr net;
+    InMask mask;
+    aid_t area;
+    int no_adv;
+};
+
+struct SimNbrCfg {
+    int rtr;
+    int next;		// Router's next neighbor
+    InAddr addr;
+    int dr_eligible;
+};
+
+struct SimStubCfg {
+    aid_t id;
+    int dflt_cost;
+    int import_summs;
+};
+
+/* Parameters of a segment, from an impair command.
+ * The command names the segment as in the scenario
+ * events, by a router and either a neighbor or the
+ * network's prefix, so it is only resolved once the
+ * whole file has been read.
+ */
+
+struct SimImpairCfg {
+    int lineno;
+    char router[16];
+    char peer[20];
+    LinkParms parms;	// phyint filled in when resolved
+};
+
+/* Index entry, from a Router ID or prefix to the
+ * position in one of the arrays.
+ */
+
+class SimCfgIndex : public AVLitem {
+  public:
+    int index;
+    inline SimCfgIndex(uns32 a, uns32 b, int i);
+};
+
+inline SimCfgIndex::SimCfgIndex(uns32 a, uns32 b, int i) : AVLitem(a, b)
+{
+    index = i;
+}
+
+class SimConfig {
+    SimRtrCfg *routers;
+    int n_routers;
+    int max_routers;
+    SimNetCfg *nets;
+    int n_nets;
+    int max_nets;
+    SimIfcCfg *ifcs;
+    int n_ifcs;
+    int max_ifcs;
+    SimAreaCfg *areas;
+    int n_areas;
+    int max_areas;
+    SimHostCfg *hosts;
+    int n_hosts;
+    int max_hosts;
+    SimRangeCfg *ranges;
+    int n_ranges;
+    int max_ranges;
+    SimNbrCfg *nbrs;
+    int n_nbrs;
+    int max_nbrs;
+    SimStubCfg *stubs;
+    int n_stubs;
+    int max_stubs;
+    SimImpairCfg *impairs;
+    int n_impairs;
+    int max_impairs;
+    LinkParms **links;	// Segment parameters, by phyint, 0 if default
+    int *segs;		// First interface, by phyint
+    int n_phyints;	// Highest phyint assigned
+    AVLtree rtr_index;	// Router ID to routers[]
+    AVLtree net_index;	// (net, mask) to nets[]
+    bool mask_used[33];	// Prefix lengths in net_index
+    bool random_refresh;
+    int lineno;
+    int find_router(char *id, bool parsing=false);
+    SimNetCfg *find_net(InAddr addr);
+    void parse_line(char *line);
+    void add_router(char **argv);
+    void add_network(char **argv);
+    void add_interface(int argc, char **argv);
+    void add_pplink(char **argv);
+    void set_drpri(char **argv);
+    void add_aggr(char **argv);
+    void add_stub(char **argv);
+    void add_loopback(char **argv);
+    void add_neighbor(char **argv);
+    void set_adj_limit(char **argv);
+    void add_impair(char **argv);
+    void resolve_impairs();
+    SimIfcCfg *new_ifc(int rtr, int phyint, InAddr addr);
+    void link_lists();
+    void join_area(int rtr, aid_t id);
+    SimStubCfg *find_stub(aid_t id);
+    void send_ifc(class CfgBatch &, SimIfcCfg *);
+  public:
+    SimConfig();
+    bool read(char *filename);
+    void start_routers();
+    void store_mappings();
+    bool download(class SimNode *);
+    int find_link(char *router, char *peer);
+    bool on_link(InAddr rtr, int phyint);
+    bool adjacent(class SimNode *);
+    inline int router_count();
+    bool set_cost(char *router, int phyint, int cost);
+    bool get_interface(int index, InAddr &rtr, int &phyint);
+    friend class DSim;
+};
+
+// Number of routers configured
+inline int SimConfig::router_count() {
+    return(n_routers);
+}
+
+/* Configuration messages for a single router, collected
+ * into SIM_CONFIG_BATCH messages. Each entry is a
+ * CfgBatchHdr followed by the message body, padded to
+ * four bytes. A batch is queued when it would otherwise
+ * exceed the maximum message size, and by flush().
+ */
+
+class CfgBatch {
+    class SimNode *node;
+    byte *buf;
+    int len;
+  public:
+    CfgBatch(class SimNode *);
+    ~CfgBatch();
+    void add(int type, int subtype, void *body, int blen);
+    void flush();
+};
+
+bool get_prefix(char *prefix, InAddr &net, InMask &mask);
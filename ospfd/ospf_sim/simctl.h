@@ -6,74 +6,78 @@
 class SimCtl {
 	/* ATUL */
 	public:
-    Tcl_Interp *interp;
     AVLtree simnodes;
-    class SimNode *nodes[NOFILE];
-    int maxfd;
+    class SimNode **nodes; // Indexed by connection
+    int n_slots;	// Size of nodes[]
+    int epoll_fd;	// Polls the connections
     int server_fd;
     int n_ticks;
     bool running;
     bool frozen;
+    // Virtual time
+    bool virtual_time;	// Tick as soon as all routers respond
+    bool skip_idle;	// Jump to the earliest pending timer
+    int n_started;	// Router processes started
+    int n_connected;	// Of those, have said Hello
+    uns32 n_lost;	// Packets lost to link parameters
+    int horizon;	// Don't advance past this tick, -1 if no limit
+    int seed;		// Routers' random number seed, 0 if none
+    AVLtree failed_links; // Segments failed by the controller
+    class SimConfig *cfg; // Topology from the configuration file
+    FILE *logfile;	// Logging messages from the routers
     // Port assignments
     int assigned_port;
     AVLtree ifmaps;
     // Database statistics
     PatTree stats;
+    // Convergence measurement
+    class ConvEvent *conv_head; // Injected events, oldest first
+    class ConvEvent *conv_tail;
+    bool conv_done;	// Converged as of last check
   //public:
-    inline SimCtl(Tcl_Interp *ti);
+    SimCtl();
     inline int elapsed_seconds();
     inline int elapsed_milliseconds();
 	/* ATUL */
     inline int get_assigned_port();
+    void open_server();
+    void configure(char *cfgfile);
+    bool step(int wait);
     void delete_router(class SimNode *node);
-    bool process_replies();
+    void add_node(class SimNode *);
+    bool process_replies(int msec=0);
     bool send_data();
+    bool all_responded();
+    void send_ticks();
+    class NodeStats *largest_group();
+    int n_synced();
+    int n_running();
+    bool converged();
+    class ConvEvent *mark_event(const char *desc);
+    void check_convergence();
+    void recolor();
     void incoming_call();
-    void simnode_handler_read(int fd);
+    bool simnode_handler_read(int fd);
     void store_mapping(uns32 net_or_addr, uns32 rtr);
     void send_addrmap(class SimNode *);
     void send_addrmap_increment(class IfMap *, class SimNode *);
     void restart_node(SimNode *, InAddr, int, uns16);
+    void restart_router(SimNode *, int grace=0);
+    void link_change(int phyint, bool up);
+    // Display, done by the Tk front end
+    virtual void color_router(class SimNode *);
+    virtual void ping_reply(int session, struct EchoReplyMsg *);
 
     friend class SimNode;
-    friend int main(int argc, char *argv[]);
-    friend int Tcl_AppInit(Tcl_Interp *);
-	/* ATUL */
-    friend void tick(int sig);
-	/* ATUL */
-    friend int StartRouter(ClientData, Tcl_Interp *, int, const char *argv[]);
-    friend int ToggleRouter(ClientData, Tcl_Interp *interp, int, char *argv[]);
-    friend int RestartRouter(ClientData,Tcl_Interp *interp, int, char *argv[]);
-    friend int HitlessRestart(ClientData,Tcl_Interp *interp,int, char *argv[]);
-    friend int AddMapping(ClientData, Tcl_Interp *interp, int, char *argv[]);
-    friend int AddNetMember(ClientData, Tcl_Interp *interp, int, char *argv[]);
-    friend int TimeStop(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int TimeResume(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendGeneral(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendArea(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendInterface(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendVL(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendNeighbor(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendAggregate(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendHost(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendExtRt(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int StartPing(ClientData, Tcl_Interp *interp, int, char *argv[]);
-    friend int StopPing(ClientData, Tcl_Interp *interp, int, char *argv[]);
-    friend int StartTraceroute(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int StartMtrace(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendGroup(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int LeaveGroup(ClientData, Tcl_Interp *, int, char *argv[]);
-	friend void sendCfgToRouterId(char *routerId);
 };
 
-inline SimCtl::SimCtl(Tcl_Interp *ti) {
-    interp = ti;
-    n_ticks = 0;
-    running = false;
-    frozen = false;
-    memset(nodes, 0, sizeof(nodes));
-    maxfd = 0;
-}
+// Access to the configuration file's contents
+int StartRouterCopy(char *args[]);
+int findLink(char *router, char *peer);
+bool routerOnLink(InAddr rtr, int phyint);
+bool setInterfaceCost(char *router, int phyint, int cost);
+bool getInterface(int index, InAddr &rtr, int &phyint);
+
 inline int SimCtl::elapsed_seconds() {
     return(n_ticks/TICKS_PER_SECOND);
 }
@@ -98,6 +102,42 @@ class NodeStats : public PatEntry {
     friend void tick(int sig);
 };
 
+/* The largest group of routers agreeing on the
+ * database of an area.
+ */
+
+class AreaGroup : public AVLitem {
+    NodeStats *largest;
+  public:
+    inline AreaGroup(InAddr area);
+    friend class SimCtl;
+};
+
+inline AreaGroup::AreaGroup(InAddr area) : AVLitem(area, 0)
+{
+    largest = 0;
+}
+
+/* An event injected into the simulation, such as a
+ * router restart, and when the routers converged
+ * after it: all agreeing on their databases, fully
+ * adjacent as the topology calls for, with
+ * nothing left to retransmit or calculate. Events
+ * that another overtakes before convergence are
+ * never marked converged.
+ */
+
+class ConvEvent {
+  public:
+    ConvEvent *next;
+    int tick;		// When injected
+    int conv_tick;	// When converged, -1 if not yet
+    int n_routers;	// Routers running at convergence
+    char *desc;
+    ConvEvent(int tick, const char *desc);
+    ~ConvEvent();
+};
+
 /* Class representing each simulated node.
  */
 
@@ -107,7 +147,13 @@ class SimNode : public AVLitem {
     int fd;		// Control connection to node
     TcpPkt pktdata;	// Pending packetized data
     bool got_tick;	// Received tick response (init to true!)
+    uns32 next_tick;	// Ticks it can go without one, 0 if any
+    bool xmt_blocked;	// Socket full, awaiting EPOLLOUT
     NodeStats *dbstats; // Stored database statistics
+    bool quiet;		// Nothing to retransmit or calculate
+    bool running;	// OSPF is running
+    AVLtree adjs;	// Full adjacencies, by phyint and neighbor ID
+    uns32 n_lost;	// Reported by this router process
     uns16 home_port;	// Unicast listening port
     bool awaiting_htl_restart;
     int color;		// Current node color
@@ -121,27 +167,6 @@ class SimNode : public AVLitem {
     SimNode(uns32 id, int file);
     inline InAddr id();
     friend class SimCtl;
-    friend int main(int argc, char *argv[]);
-	//ATUL
-    friend void tick(int sig);
-    friend int ToggleRouter(ClientData, Tcl_Interp *interp, int, char *argv[]);
-    friend int RestartRouter(ClientData,Tcl_Interp *interp, int, char *argv[]);
-    friend int HitlessRestart(ClientData,Tcl_Interp *interp,int, char *argv[]);
-    friend int SendGeneral(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendArea(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendInterface(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendVL(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendNeighbor(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendAggregate(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendHost(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendExtRt(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int StartPing(ClientData, Tcl_Interp *interp, int, char *argv[]);
-    friend int StopPing(ClientData, Tcl_Interp *interp, int, char *argv[]);
-    friend int StartTraceroute(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int StartMtrace(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int SendGroup(ClientData, Tcl_Interp *, int, char *argv[]);
-    friend int LeaveGroup(ClientData, Tcl_Interp *, int, char *argv[]);
-	friend void sendCfgToRouterId(char *routerId);
 };
 
 inline InAddr SimNode::id() {
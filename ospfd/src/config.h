@@ -175,8 +175,9 @@ struct CfgAuKey {
     InAddr address;	// IP address
     int	phyint;		// Physical interface
     byte key_id; 	// Key ID
-
-    byte auth_key[16];	// Authentication key
+    byte algorithm;	// CRYPT_MD5 or CRYPT_HMAC_SHA256
+    byte key_len;	// Significant bytes of auth_key
+    byte auth_key[CRYPT_KEYMAX]; // Authentication key
     int start_accept;	// Seconds
     int start_generate;
     int stop_generate;
@@ -0,0 +1,39 @@
+
+/* The state that the OSPF implementation keeps in globals
+ * and class statics: the protocol instance, its system
+ * interface, the timer queue, the routing and next hop
+ * tables, the configuration list and the database aging
+ * bins. A process running one OSPF instance just uses
+ * the globals. One running many, like the single-process
+ * simulator, gives each instance an OspfContext, and
+ * activates it before calling into that instance; the
+ * globals then always describe the active instance.
+ */
+
+class OspfContext {
+    OSPF *c_ospf;
+    OspfSysCalls *c_sys;
+    PriQ c_timerq;
+    INtbl *c_inrttbl;
+    FWDtbl *c_fa_tbl;
+    INrte *c_default_route;
+    ConfigItem *c_cfglist;
+    PatTree c_nhdb;
+    LSA **age_bins;
+    int bin0;
+    int32 *refresh_bins;
+    int refresh_bin0;
+    static OspfContext *active;
+    void save();
+    void load();
+  public:
+    OspfContext(OspfSysCalls *);
+    ~OspfContext();
+    void activate();
+    inline bool is_active();
+};
+
+inline bool OspfContext::is_active()
+{
+    return(active == this);
+}
@@ -0,0 +1,83 @@
+/*
+ *   OSPFD routing daemon
+ *   Copyright (C) 1998 by John T. Moy
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/* Counters of protocol events, incremented on the
+ * packet processing paths. Each thread that counts has
+ * its own block, written by no other thread, so that an
+ * increment is a plain load and store with no locking
+ * or bus-locked instruction. Blocks are padded to a cache line
+ * so that threads don't contend. Exporters on other threads
+ * read the counters without synchronization, and
+ * may see values that are slightly out of date.
+ */
+
+enum {
+    CTR_RX_PKT = 0,	// Received, indexed by OSPF packet type
+    CTR_TX_PKT = CTR_RX_PKT + SPT_LSACK + 1, // Sent, by packet type
+    CTR_LSA_RX = CTR_TX_PKT + SPT_LSACK + 1, // LSAs in received Updates
+    CTR_LSA_INSTALL,	// LSAs installed in the database
+    CTR_LSA_DUP,	// Duplicate LSAs received
+    CTR_ACK_RX,		// LSAs acknowledged by neighbors
+    CTR_ACK_TX,		// LSAs acknowledged to neighbors
+    CTR_RXMT,		// LSAs retransmitted
+    CTR_PKT_XSUM,	// Received packets with bad checksum
+    CTR_RAW_RX,		// Packets read from the raw socket
+    CTR_RING_DROP,	// Packets dropped, receive queue full
+    CTR_LOG_DROP,	// Logging messages dropped, ring full
+    CTR_DROP,		// Drops and errors, by logging message
+    CTR_MAX = CTR_DROP + IGMP_RCV_NOIFC - RCV_SHORT + 1,
+};
+
+struct CtrBlock {
+    uns32 ctr[CTR_MAX];
+    inline void inc(int i);
+    inline void add(int i, uns32 val);
+    inline uns32 get(int i);
+} __attribute__ ((aligned (64)));
+
+/* Called only by the thread owning the block.
+ */
+
+inline void CtrBlock::inc(int i)
+
+{
+    __atomic_store_n(&ctr[i], ctr[i] + 1, __ATOMIC_RELAXED);
+}
+
+inline void CtrBlock::add(int i, uns32 val)
+
+{
+    __atomic_store_n(&ctr[i], ctr[i] + val, __ATOMIC_RELAXED);
+}
+
+/* Called from any thread.
+ */
+
+inline uns32 CtrBlock::get(int i)
+
+{
+    return(__atomic_load_n(&ctr[i], __ATOMIC_RELAXED));
+}
+
+// Counters of the thread running the OSPF protocol
+extern CtrBlock ospf_ctrs;
+// Names, labels and descriptions, for exporters
+const char *ctr_name(int i);
+const char *ctr_label(int i);
+const char *ctr_help(int i);
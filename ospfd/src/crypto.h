@@ -0,0 +1,66 @@
+/*
+ *   OSPFD routing daemon
+ *   Copyright (C) 1998 by John T. Moy
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/* Digests used by OSPF cryptographic authentication:
+ * keyed MD5 (RFC 2328, Appendix D.4.3) and HMAC-SHA-256
+ * (RFC 5709). Both work directly on the packet, with no
+ * copying beyond the final padded block.
+ */
+
+enum {
+    CRYPT_MD5 = 0,	// Keyed MD5
+    CRYPT_HMAC_SHA256,	// HMAC-SHA-256
+};
+
+enum {
+    MD5_LEN = 16,	// Digest lengths
+    SHA256_LEN = 32,
+    SHA256_BLOCK = 64,	// SHA-256 block size
+    CRYPT_KEYMAX = 64,	// Longest key accepted
+};
+
+void md5_digest(const byte *data, int len, byte *digest);
+
+/* SHA-256 hash state. Only whole blocks are hashed
+ * until final(), so the state after any number of
+ * blocks can be saved and reused.
+ */
+
+struct Sha256 {
+    uns32 h[8];
+    uns32 n_blocks;	// Blocks hashed so far
+    void init();
+    void blocks(const byte *data, int n);
+    void final(const byte *data, int len, byte *digest);
+};
+
+/* HMAC-SHA-256 key schedule: the hash states after
+ * the inner and outer padded keys, computed once when
+ * the key is configured.
+ */
+
+struct HmacKey {
+    Sha256 inner;
+    Sha256 outer;
+    void set(const byte *key, int len);
+    void digest(const byte *data, int len, byte *digest);
+};
+
+// RFC 5709 Apad, placed where the digest goes before hashing
+const uns32 HmacApad = 0x878FE1F3;
@@ -0,0 +1,70 @@
+/*
+ *   OSPFD routing daemon
+ *   Copyright (C) 1998 by John T. Moy
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/* Binary ring of logging messages. OSPF::spflog() and
+ * the OSPF::log() routines append a record holding the
+ * message number, the time and the raw arguments (strings,
+ * integers and addresses); nothing is formatted on the
+ * protocol's thread. A single consumer, usually a
+ * separate thread, turns the records into text with
+ * next(). The producer never waits: when the ring is full
+ * the message is dropped and counted.
+ *
+ * The producer owns head, the consumer owns tail. Each
+ * reads the other's index with acquire semantics, and
+ * publishes its own with release semantics, so that
+ * no locking is needed.
+ */
+
+class EvLog {
+    enum {
+	EVLOG_SIZE = 256*1024, // Ring bytes, a power of two
+	EVREC_MAX = 800, // Largest record, as the old logbuf
+	EVREC_HDR = 12,	// length, msgno, sec, msec
+    };
+    enum {
+	EV_STR = 1,	// uns16 length, then the characters
+	EV_INT,		// int
+	EV_ADDR,	// InAddr, machine byte-order
+    };
+    byte *ring;
+    uns32 head;		// End of published records
+    uns32 tail;		// Start of unread records
+    uns32 wptr;		// End of record being built
+    uns32 rec;		// Start of record being built
+    bool open;		// Record being built
+    uns32 drops;	// Messages lost, ring full
+    uns32 drops_seen;	// Reported by consumer
+    void put(const void *, int len);
+    void get(uns32 off, void *, int len);
+    bool room(int len);
+  public:
+    EvLog();
+    void begin(int msgno, SPFtime &tstamp);
+    void str(const char *);
+    void num(int);
+    void addr(InAddr);
+    bool commit();
+    bool next(int &msgno, SPFtime &tstamp, char *buf, int len);
+    uns32 new_drops();
+    void drain(class OspfSysCalls *);
+};
+
+// Logging messages of the thread running the OSPF protocol
+extern EvLog ospf_evlog;
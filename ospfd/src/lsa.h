@@ -43,9 +43,9 @@ protected:
         we_orig:1;	// We have originated this LSA
     uns16 lsa_hour;	// Hour counter, for DoNotAge refresh
 
-    static LSA *AgeBins[MaxAge+1];// Aging Bins
+    static LSA **AgeBins;	// Aging Bins, MaxAge+1 of them
     static int Bin0;	// Current age 0 bin
-    static int32 RefreshBins[MaxAgeDiff]; // Refresh bins
+    static int32 *RefreshBins; // Refresh bins, MaxAgeDiff of them
     static int RefreshBin0; // Current refresh bin
 
     void hdr_parse(LShdr *hdr);
@@ -90,6 +90,7 @@ public:
     friend class LsaListIterator;
     friend class LocalOrigTimer;
     friend class DBageTimer;
+    friend class OspfContext;
     friend void hdr_parse(LSA *, LShdr *);
     friend LShdr& LShdr::operator=(class LSA &lsa);
     friend inline uns16 Age2Bin(age_t);
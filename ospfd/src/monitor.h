@@ -54,6 +54,21 @@ struct MonRqRte {
     InAddr mask;
 };
 
+/* Request for many LSAs at once, starting after the
+ * LSA given by the cursor. The response is limited by
+ * max_lsas, and by the work budget MON_BULK_BYTES.
+ */
+
+struct MonRqBulk {
+    MonRqLsa cursor;	// Start after this LSA
+    uns32 max_lsas;	// Maximum LSAs in response (0 => no limit)
+    byte one_area;	// Stop at end of cursor's area
+    byte pad1;
+    uns16 pad2;
+};
+
+const int MON_BULK_BYTES = 16384; // LSA bytes per bulk response
+
 /* Response to a request for global statistics.
  */
 
@@ -74,6 +89,12 @@ struct StatRsp {
     byte vminor;
     uns16 fill1;
     uns32 n_orig_allocs;
+    uns32 n_fib_adds;	// Kernel route adds/modifies
+    uns32 n_fib_dels;	// Kernel route deletes
+    uns32 n_fib_errors;	// Kernel updates that failed
+    uns32 n_fib_retries;// Kernel updates retried
+    uns32 n_fib_pending;// Kernel updates unacknowledged
+    uns32 fib_rate;	// Kernel updates in last second
 };
 
 /* Response to a request for area statistics.
@@ -181,6 +202,85 @@ struct OpqRsp {
     aid_t a_id;
 };
 
+/* Response to a bulk LSA request. Followed by n_lsas
+ * entries, each a MonRqLsa identifying the LSA followed
+ * by the LSA itself. To continue, send the cursor back
+ * in the next request.
+ */
+
+struct BulkRsp {
+    MonRqLsa cursor;	// Last LSA returned
+    uns32 n_lsas;	// Number of LSAs in response
+    byte more;		// Set if database not yet exhausted
+    byte pad1;
+    uns16 pad2;
+};
+
+/* Response to a request for the routing calculation
+ * history. Followed by n_recs SpfRecords, most recent first.
+ */
+
+struct SpfHistRsp {
+    uns32 n_dijkstra;	// Total # routing calculations
+    uns32 n_recs;	// # records in response
+};
+
+/* Response to a request for convergence latencies.
+ */
+
+struct ConvRsp {
+    LatHist detect;	// LSA receipt to routing calculation
+    LatHist fib;	// Routing calculation to kernel install
+    LatHist total;	// LSA receipt to kernel install
+};
+
+/* A change to the routing table, sent to subscribers.
+ * For deletions, only the prefix is filled in.
+ */
+
+struct RteEvent {
+    byte event;		// RTEV_ADD, etc.
+    byte pad1;
+    uns16 pad2;
+    RteRsp rte;
+};
+
+enum {
+    RTEV_ADD = 1,	// New route
+    RTEV_CHANGE,	// Cost or next hops changed
+    RTEV_DELETE,	// Route removed
+};
+
+/* Frame sent to a subscriber to routing table changes.
+ * Followed by n_events RteEvents. A snapshot of the
+ * whole table, sent on subscribing and whenever the
+ * subscriber falls too far behind, begins with
+ * RTSUB_SNAPSTART (the subscriber should then forget its
+ * current table) and ends with RTSUB_SNAPEND.
+ */
+
+struct RteSubRsp {
+    uns32 n_events;
+    byte flags;
+    byte pad1;
+    uns16 pad2;
+};
+
+enum {
+    RTSUB_SNAPSTART = 0x01, // First frame of snapshot
+    RTSUB_SNAPEND = 0x02, // Last frame of snapshot
+    RTSUB_CLOSED = 0x04, // Subscription cancelled, last frame
+};
+
+/* Response to a request for the flight recorder's
+ * contents. Followed by n_recs TraceRecs, oldest first.
+ */
+
+struct TraceRsp {
+    uns32 n_events;	// Total # events recorded
+    uns32 n_recs;	// # records in response
+};
+
 /* Overall format of monitoring requests and responses.
  */
 
@@ -201,6 +301,7 @@ struct MonMsg {
 	MonRqLsa lsarq;
         MonRqLLLsa lllsarq;
 	MonRqRte rtrq;
+	MonRqBulk bulkrq;
 
         StatRsp statrsp;// Responses
 	AreaRsp arearsp;
@@ -208,6 +309,11 @@ struct MonMsg {
 	NbrRsp nbrsp;
 	RteRsp rtersp;
         OpqRsp opqrsp;
+	BulkRsp bulkrsp;
+	SpfHistRsp spfrsp;
+	ConvRsp convrsp;
+	RteSubRsp subrsp;
+	TraceRsp tracersp;
     } body;
 };
 
@@ -227,6 +333,12 @@ enum {
     MonReq_OpqReg,	// Register for Opaque-LSAs
     MonReq_OpqNext,	// Get next Opaque-LSA
     MonReq_LLLSA,	// Dump Link-local LSA contents
+    MonReq_LSABulk,	// Dump many LSAs at once
+    MonReq_SpfHist,	// Recent routing calculations
+    MonReq_Conv,	// Convergence latencies
+    MonReq_RteSub,	// Subscribe to routing table changes
+    MonReq_RteUnsub,	// Cancel subscription
+    MonReq_Trace,	// Flight recorder contents
 
     Stat_Response = 100, // Global statistics response
     Area_Response,	// Area response
@@ -236,6 +348,11 @@ enum {
     Rte_Response,	// Routing table entry
     OpqLSA_Response,	// Opaque-LSA response
     LLLSA_Response,	// Link-local LSA
+    LSABulk_Response,	// Many LSAs
+    SpfHist_Response,	// Routing calculation history
+    Conv_Response,	// Convergence latencies
+    RteSub_Response,	// Routing table changes
+    Trace_Response,	// Flight recorder contents
 
     OSPF_MON_VERSION = 1, // Version of monitoring messages
 };
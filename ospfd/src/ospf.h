@@ -9,6 +9,70 @@ class DBageTimer : public ITimer {
 // Global timer queue
 extern PriQ timerq;		// Currently pending timers
 
+/* Phases of the full routing calculation, timed
+ * separately. Kernel routing table updates made during
+ * rt_scan() are counted under SPH_FIB rather than SPH_RTSCAN.
+ */
+
+enum {
+    SPH_DIJKSTRA = 0,	// OSPF::dijkstra()
+    SPH_UPDBRS,		// OSPF::update_brs()
+    SPH_INVALIDATE,	// OSPF::invalidate_ranges()
+    SPH_RTSCAN,		// OSPF::rt_scan()
+    SPH_ADVERTISE,	// OSPF::advertise_ranges()
+    SPH_RESOLVE,	// FWDtbl::resolve()
+    SPH_FIB,		// Kernel routing table updates
+    SPH_MAX,
+};
+
+/* Record of a single full routing calculation, kept in
+ * a ring of the last SpfHistory calculations.
+ * Durations are in microseconds. Also used, in network
+ * byte order, in the monitor's SPF history response.
+ */
+
+struct SpfRecord {
+    uns32 start_sec;	// When started, in elapsed time
+    uns32 start_msec;
+    uns32 duration;	// Total
+    uns32 phase[SPH_MAX]; // By phase
+    uns32 n_nodes;	// Vertices added to the SPF tree
+    uns32 n_edges;	// Links examined
+    uns32 n_changes;	// Routing table entries changed
+};
+
+/* Log-scale histogram of latencies, in microseconds.
+ * Bucket i counts latencies in [2**i, 2**(i+1)), the
+ * first bucket also counting zero and the last everything
+ * longer. Also used, in network byte order, in the
+ * monitor's convergence response.
+ */
+
+struct LatHist {
+    uns32 count;	// # latencies recorded
+    uns32 max;		// Longest latency
+    uns32 bucket[LatBuckets];
+
+    void add(uns32 usecs);
+};
+
+/* A convergence measurement not yet complete: routing
+ * calculations "first" through "last", and the topology
+ * changes they account for, whose routes have not all
+ * reached the kernel. Calculations beyond ConvGens
+ * outstanding are merged into the newest measurement.
+ */
+
+struct ConvGen {
+    uns32 first;	// Calculation generations covered
+    uns32 last;
+    uns32 rcvd;		// Earliest change received
+    uns32 calc;		// First calculation began
+    bool marked;	// Routes handed to the system, up to "mark"
+    uns32 mark;		// From sys->rt_mark()
+    int n_deferred;	// Routes still held back in krtdefers
+};
+
 /* The OSPF base class. This class contains all the data necessary
  * to run a sungle instance of the OSPF protocol.
  */
@@ -50,6 +114,7 @@ class OSPF : public ConfigItem {
     bool delete_neighbors; // Neighbors being deleted?
     AVLtree phyints;	// Physical interfaces
     AVLtree krtdeletes;	// Deleted, unsynced kernel routing entries
+    AVLtree krtdefers;	// Kernel updates deferred, kernel busy
     bool need_remnants; // Yet to get remnants?
     // Flooding queues
     int	n_local_flooded;// AS-external-LSAs originated this tick
@@ -81,12 +146,21 @@ class OSPF : public ConfigItem {
 	ase_sched:1;	// true => all ases should be reexamined
     // Statistics
     uns32 n_dijkstras;
+    SpfRecord spf_hist[SpfHistory]; // Recent routing calculations
+    SpfRecord *spf_cur;	// Calculation in progress
+    // Convergence measurement
+    uns32 rcv_stamp;	// Receipt of Update being processed, or 0
+    bool conv_sched;	// Topology change awaiting calculation
+    uns32 conv_rcvd;	// When that change was received
+    uns32 conv_gen;	// Latest calculation generation
+    ConvGen conv_q[ConvGens]; // Open measurements, oldest first
+    int conv_head;
+    int conv_count;
+    LatHist lat_detect;	// Receipt to routing calculation
+    LatHist lat_fib;	// Routing calculation to kernel install
+    LatHist lat_total;	// Receipt to kernel install
+    AVLtree rte_subs;	// Subscribers to routing table changes
     // Logging variables
-    int logno;		// Logging event number
-	/* ATUL */
-    char logbuf[800];   // Logging buffer
-    char *logptr;       // Current place in logging buffer
-    char *logend;	// End of logging buffer
     int base_priority;
     bool disabled_msgno[MAXLOG+1];
     bool enabled_msgno[MAXLOG+1];
@@ -112,6 +186,18 @@ class OSPF : public ConfigItem {
     void rte_stats(class MonMsg *, int conn_id);
     void opq_stats(class MonMsg *, int con_id);
     void lllsa_stats(class MonMsg *, int conn_id);
+    void lsa_bulk(class MonMsg *, int conn_id);
+    void spf_history(class MonMsg *, int conn_id);
+    void conv_stats(class MonMsg *, int conn_id);
+    void trace_stats(class MonMsg *, int conn_id);
+    void rte_fill(struct RteRsp *, class INrte *);
+    void rte_subscribe(class MonMsg *, int conn_id);
+    void rte_notify(class INrte *, byte event);
+    void rte_sub_flush();
+    void rte_sub_send(class RteSub *, class MonMsg *, int n, byte flags);
+    void rte_snapshot(class RteSub *);
+    void rte_snap_continue(class RteSub *);
+    void rte_sub_cancel(class MonMsg *, int conn_id);
 
     // Utility routines
     void clear_config();
@@ -198,6 +284,11 @@ class OSPF : public ConfigItem {
     void host_dijk_init(PriQ &cand);
     void add_cand_node(SpfIfc *ip, TNode *node, PriQ &cand);
     void dijkstra();
+    uns32 spf_phase(int phase, uns32 begin, uns32 &fib_mark);
+    void conv_change();
+    void conv_calc(uns32 start);
+    void conv_installed();
+    void conv_defer(uns32 gen, int delta);
 	void update_brs();
     void invalidate_ranges();
     void rt_scan();
@@ -205,6 +296,8 @@ class OSPF : public ConfigItem {
     void advertise_ranges();
     void do_all_ases();
     void krt_sync();
+    void krt_resume();
+    void remnant_sweep();
    
     // Logging routines
     bool spflog(int, int);
@@ -233,7 +326,7 @@ class OSPF : public ConfigItem {
     // Entry points into the OSPF code
     OSPF(uns32 rtid, SPFtime grace);
     ~OSPF();
-    void rxpkt(int phyint, InPkt *pkt, int plen);
+    void rxpkt(int phyint, InPkt *pkt, int plen, uns32 rcvd=0);
     int	timeout();
     void tick();
     void monitor(struct MonMsg *msg, byte type, int size, int conn_id);
@@ -242,6 +335,7 @@ class OSPF : public ConfigItem {
     void phy_down(int phyint);
     void krt_delete_notification(InAddr net, InMask mask);
     void remnant_notification(InAddr net, InMask mask);
+    void rte_unsubscribe(int conn_id);
     MPath *ip_lookup(InAddr dest);
     InAddr ip_source(InAddr dest);
     InAddr if_addr(int phyint);
@@ -250,6 +344,9 @@ class OSPF : public ConfigItem {
     inline rtid_t my_id();
     inline int n_extLSAs();
     inline uns32 xsum_extLSAs();
+    uns32 n_rxmts();
+    inline int n_exchanges();
+    inline bool calc_pending();
     // Configuration routines
     void cfgOspf(struct CfgGen *msg);
     void cfgArea(struct CfgArea *msg, int status);
@@ -331,6 +428,14 @@ inline InAddr OSPF::my_addr()
 {
     return(myaddr);
 }
+inline int OSPF::n_exchanges()
+{
+    return(n_dbx_nbrs);
+}
+inline bool OSPF::calc_pending()
+{
+    return(full_sched != 0);
+}
 
 // non-class-related function declarations
 void lsa_flush(LSA *lsap);
@@ -14,6 +14,7 @@
 #include "lshdr.h"
 #include "spfparam.h"
 #include "tlv.h"
+#include "crypto.h"
 #include "config.h"
 #include "pat.h"
 #include "rte.h"
@@ -25,7 +26,10 @@
 #include "spfifc.h"
 #include "spfnbr.h"
 #include "spflog.h"
+#include "counters.h"
+#include "evlog.h"
 #include "ospf.h"
 #include "dbage.h"
 #include "iterator.h"
 #include "globals.h"
+#include "trace.h"
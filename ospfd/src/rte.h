@@ -172,7 +172,8 @@ class INrte : public RTE {
   public:
     class summLSA *summs;       // summary-LSAs
     byte range:1,		// Configured area address range?
-	 ase_orig:1;		// Have we originated an AS-external-LSA?
+	 ase_orig:1,		// Have we originated an AS-external-LSA?
+	 in_kernel:1;		// Last installed as add (not delete)?
 
     inline INrte(uns32 xnet, uns32 xmask);
     inline uns32 net();
@@ -188,6 +189,7 @@ class INrte : public RTE {
     void run_inter_area(); // Calculate inter-area routes
     void incremental_summary(SpfArea *);
     void sys_install();  // Install routes into kernel
+    void sys_write();	// Write current state to kernel
     virtual void declare_unreachable();
 
     friend class SpfArea;
@@ -205,6 +207,7 @@ inline INrte::INrte(uns32 xnet, uns32 xmask) : RTE(xnet, xmask)
     summs = 0;
     range = false;
     ase_orig = false;
+    in_kernel = false;
 }
 inline uns32 INrte::net()
 {
@@ -342,3 +345,14 @@ class KrtSync : public AVLitem {
     SPFtime tstamp;
     KrtSync(InAddr net, InMask mask);
 };
+
+/* A routing table entry whose kernel update is being
+ * held back, and the generation of the routing calculation
+ * that produced it.
+ */
+
+class KrtDefer : public AVLitem {
+  public:
+    uns32 gen;
+    KrtDefer(InAddr net, InMask mask, uns32 g) : AVLitem(net, mask), gen(g) {}
+};
@@ -42,16 +42,19 @@ inline DAckTimer::DAckTimer(class SpfIfc *ifc)
 }
 
 /* Cryptographic keys. Identified by Key ID, and providing
- * a 16-byte string to be used in an MD5 authentication
- * scheme. Also includes the time at which the key should be
- * activated.
+ * the secret used in either keyed MD5 or HMAC-SHA-256
+ * authentication. For HMAC-SHA-256 the key schedule
+ * is computed when the key is configured. Also includes
+ * the time at which the key should be activated.
  */
 
 class CryptK : public ConfigItem {
     const byte key_id;
     class SpfIfc *ip;
     CryptK *link; 	// Chained in SpfIfc
-    byte key[16];
+    byte algorithm;	// CRYPT_MD5, etc.
+    byte key[MD5_LEN];	// Keyed MD5 secret
+    HmacKey hmac;	// HMAC-SHA-256 key schedule
     // key activation timers
     // stop timers are optional
     bool stop_generate_specified;
@@ -63,6 +66,7 @@ class CryptK : public ConfigItem {
   public:
     inline CryptK(byte id);
     virtual void clear_config();
+    inline int digest_len();
     friend class SpfIfc;
     friend class KeyIterator;
     friend class OSPF;
@@ -72,6 +76,11 @@ inline CryptK::CryptK(byte id) : key_id(id)
 {
 }
 
+inline int CryptK::digest_len()
+{
+    return((algorithm == CRYPT_HMAC_SHA256) ? SHA256_LEN : MD5_LEN);
+}
+
 /* The OSPF interface class. Divided into two separate parts.
  * The first part contains the configurable interface parameters
  * (as described in Appendix C.3 of the OSPF specification).
@@ -176,6 +185,7 @@ class SpfIfc : public ConfigItem {
     int verify(Pkt *pdesc, class SpfNbr *np);
     void md5_generate(Pkt *pdesc);
     int md5_verify(Pkt *pdesc, class SpfNbr *np);
+    void crypt_digest(CryptK *, byte *pkt, int length, byte *digest);
     void recv_hello(Pkt *pdesc);
     void send_hello(bool empty=false);
     int build_hello(Pkt *, uns16 size);
@@ -78,9 +78,13 @@ enum {
     LOG_HELPER_STOP,	// Leave helper mode
     LOG_GRACE_REJECT,	// Reject grace request
     LOG_HTLEXIT,	// Exiting hitless restart
+    LOG_TRACE,		// Flight recorder event
     MAXLOG,		// KEEP THIS LAST!!!!
 };
 
+// Text of each logging message
+char *msgtext(int msgno);
+
 /* Error codes used in calling OspfSysCalls::halt(), terminating
  * the program for a specified reason.
  * 0 is reserved to indicated that shutdown was requested
@@ -6,3 +6,12 @@ const uns32 Infinity = 0xffffffffL; // Unreachable cost
 const uns16 MAX_COST = 0xffff; // Maximum link cost
 const uns16 VL_MTU = 1500;	// MTU on virtual links
 const int MAXPATH = 4;		// # equal cost paths
+const int RemnantHoldTime = 40;	// Seconds before sweeping remnants
+const int SpfHistory = 32;	// # routing calculations remembered
+const int LatBuckets = 25;	// Latency histogram buckets, log2 usec
+const int ConvGens = 16;	// Convergence measurements open at once
+const int RteSubChanges = 4096;	// Pending route changes before resync
+const int RteSubBacklog = 32;	// Queued frames before holding changes
+const int RteSubBatch = 64;	// Route events per frame
+const int MaxDigestLen = 32;	// Longest authentication digest
+const int FlightRecSize = 2048;	// Events in flight recorder, power of 2
@@ -15,6 +15,7 @@ struct Pkt {		// As received from IP
     bool llmult;	// Link level multicast?
     bool hold;		// Don't free
     bool xsummed;	// Body already checksummed?
+    uns32 rcvd;		// When received, in usecs (0 if unknown)
     // Initialized by OSPF
     SpfPkt *spfpkt;	// OSPF packet header
     byte *end;		// End of packet
@@ -39,10 +40,21 @@ struct FsmTran {
     int	new_state;	// New state
 };
 
+/* Fletcher checksum kernels, for fletcher_select().
+ */
+
+enum {
+    FL_BEST = 0,	// Fastest supported
+    FL_SCALAR,		// Byte at a time
+    FL_SSE2,		// 16 bytes at a time
+    FL_AVX2,		// 32 bytes at a time
+};
+
 /* Utility routines implemented in spfutil.C
  */
 
 uns16 fletcher(byte *message, int mlen, int offset);
+bool fletcher_select(int kernel);
 uns16 incksum(uns16 *, int len, uns16 seed=0);
 
 // Standard min/max functions
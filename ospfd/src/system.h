@@ -1,4 +1,22 @@
 
+/* Counters kept by the system's interface to the kernel
+ * routing table, and reported in the global statistics.
+ */
+
+struct FibStats {
+    uns32 n_adds;	// Route adds/modifies sent
+    uns32 n_dels;	// Route deletes sent
+    uns32 n_errors;	// Requests failed by the kernel
+    uns32 n_retries;	// Requests sent again
+    uns32 n_pending;	// Requests awaiting acknowledgment
+    uns32 rate;		// Requests sent in second rate_sec
+    uns32 rate_sec;
+    uns32 rate_count;	// Requests sent in current second
+
+    void count(bool add);
+    uns32 install_rate();
+};
+
 /* Class implementing system functions, such as time of day.
  */
 
@@ -27,6 +45,14 @@ public:
     virtual void sys_spflog(int msgno, char *msgbuf)=0;
     virtual void store_hitless_parms(int, int, struct MD5Seq *) = 0;
     virtual void halt(int code, char *string)=0;
+    virtual bool rt_busy();
+    virtual uns32 rt_mark();
+    virtual bool rt_done(uns32 mark);
+    virtual int monitor_backlog(int conn_id);
+    virtual uns32 usecs();
+    virtual void log_posted();
+
+    struct FibStats fibstats;
 };
 
 /* Class used to indicate MD5 sequence numbers in use
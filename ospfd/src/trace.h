@@ -0,0 +1,108 @@
+/*
+ *   OSPFD routing daemon
+ *   Copyright (C) 1998 by John T. Moy
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/* Tracepoints on the protocol's hot paths. Each one
+ * is both a statically defined (USDT) probe, provider
+ * "ospfd", for bpftrace or perf to attach to, and an entry
+ * in the flight recorder, a ring of the last FlightRecSize
+ * events that is always on. The ring is dumped to the
+ * log by halt(), and can be retrieved at any time with
+ * the monitor's MonReq_Trace request.
+ *
+ * When <sys/sdt.h> is not installed, the probes compile
+ * to nothing and only the flight recorder remains.
+ */
+
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define OSPF_PROBE(name, a0, a1, a2, a3) \
+	DTRACE_PROBE4(ospfd, name, a0, a1, a2, a3)
+#endif
+#endif
+#ifndef OSPF_PROBE
+#define OSPF_PROBE(name, a0, a1, a2, a3)
+#endif
+
+/* Trace a single event. The arguments must be
+ * simple values, as they may be evaluated twice.
+ */
+
+#define OSPF_TRACE(event, name, a0, a1, a2, a3) \
+	do { \
+	    ospf_flight.add(event, a0, a1, a2, a3); \
+	    OSPF_PROBE(name, a0, a1, a2, a3); \
+	} while (0)
+
+/* Tracepoints, and the meaning of their arguments.
+ */
+
+enum {
+    TR_RXPKT = 1,	// phyint, packet type, source, length
+    TR_RECV_UPDATE,	// neighbor ID, # LSAs
+    TR_FLOOD,		// LS type, LS ID, advertising router, seqno
+    TR_ADDLSA,		// LS type, LS ID, advertising router, seqno
+    TR_DIJKSTRA,	// # calculations, # nodes, # edges
+    TR_RT_SCAN,		// # routing calculations, transit changes
+    TR_NBR_FSM,		// neighbor ID, event, old state, new state
+    TR_IFC_FSM,		// interface address, event, old, new state
+};
+
+/* A single event in the flight recorder. Also used,
+ * in network byte order, in the monitor's trace response.
+ */
+
+struct TraceRec {
+    uns32 sec;		// Elapsed time
+    uns32 msec;
+    uns16 event;	// TR_RXPKT, etc.
+    uns16 pad;
+    uns32 arg[4];
+};
+
+class FlightRec {
+    TraceRec recs[FlightRecSize];
+    uns32 n_events;	// Ever recorded
+  public:
+    inline void add(int event, uns32 a0, uns32 a1, uns32 a2, uns32 a3);
+    int get(TraceRec *copy, uns32 &total);
+    void dump(class OspfSysCalls *);
+};
+
+extern SPFtime sys_etime;
+
+/* Add an event, overwriting the oldest.
+ */
+
+inline void FlightRec::add(int event, uns32 a0, uns32 a1, uns32 a2, uns32 a3)
+
+{
+    TraceRec *rec;
+
+    rec = &recs[n_events++ % FlightRecSize];
+    rec->sec = sys_etime.sec;
+    rec->msec = sys_etime.msec;
+    rec->event = event;
+    rec->arg[0] = a0;
+    rec->arg[1] = a1;
+    rec->arg[2] = a2;
+    rec->arg[3] = a3;
+}
+
+extern FlightRec ospf_flight;